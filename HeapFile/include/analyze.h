@@ -0,0 +1,85 @@
+#ifndef _ANALYZE_H
+#define _ANALYZE_H
+
+#include "minirel.h"
+#include "cpage.h"
+
+class Scan;
+
+// Number of buckets of an equi-depth histogram.
+const int HIST_BUCKETS = 10;
+
+// A HyperLogLog sketch has 2^HLL_BITS one-byte registers; its distinct
+// counts are within about 1.04 / sqrt(2^HLL_BITS) (6.5%) of the truth.
+const int HLL_BITS = 8;
+
+// Number of records HeapFile::analyze samples by default.
+const int ANALYZE_SAMPLE_ROWS = 30000;
+
+// Strings are kept in the statistics by their first STAT_PREFIX bytes.
+const int STAT_PREFIX = 4;
+
+const int TABLE_STATS_MAGIC = 0x53544154;   // "STAT"
+
+// StatValue: a column value as the statistics keep it.  Integers and
+// reals are kept as they are, strings by a prefix (compared like strncmp
+// over STAT_PREFIX bytes).
+union StatValue {
+    int   i;
+    float r;
+    char  s[STAT_PREFIX];
+};
+
+// ColumnStats: what HeapFile::analyze found out about one column.
+//
+// A field is null if the record ends before it, or, for a string, if the
+// string is empty.  The histogram is equi-depth: each of its HIST_BUCKETS
+// buckets holds about the same number of non-null values, and bucket b
+// covers bounds[b] .. bounds[b + 1].  So bounds[0] is the smallest value
+// and bounds[HIST_BUCKETS] the largest (of the sample, that is).
+struct ColumnStats {
+    AttrType  type;
+    int       nullCnt;                      // null fields in the file (estimated)
+    int       distinct;                     // distinct non-null values in the file (estimated)
+    StatValue bounds[HIST_BUCKETS + 1];     // histogram bucket boundaries
+};
+
+// TableStats: the statistics of a heap file, as stored on its stats page
+// (see HeapFile::analyze).  It fits on one page for up to MAX_CPAGE_COLS
+// columns.
+struct TableStats {
+    int         magic;                      // TABLE_STATS_MAGIC
+    int         numCols;
+    int         recCnt;                     // records in the file when it was analyzed
+    int         sampled;                    // records the statistics come from
+    ColumnStats cols[MAX_CPAGE_COLS];
+
+    // Compute the statistics of a file of recCnt records from the records
+    // scan returns (a sample of them), laid out as schema says.
+    Status collect(Scan *scan, const RecordSchema &schema, int recCnt);
+
+    // Estimated fraction of the records whose column col satisfies
+    // "col op value" (or, for aopRANGE, value <= col <= value2), as the
+    // terms of a Predicate.  value points to a value of the column's type:
+    // an int, a float, or a string of the column's size.
+    double selectivity(int col, AttrOperator op, const void *value, const void *value2 = NULL) const;
+};
+
+// HyperLogLog: a sketch of the number of distinct values added to it,
+// in a fixed 2^HLL_BITS bytes however many values there are.
+class HyperLogLog {
+
+  public:
+    HyperLogLog();
+
+    // add the len bytes at value
+    void add(const char *value, int len);
+
+    // estimated number of distinct values added
+    double estimate() const;
+
+  private:
+    unsigned char reg[1 << HLL_BITS];
+};
+
+#endif // _ANALYZE_H
@@ -0,0 +1,81 @@
+#ifndef _APPENDER_H
+#define _APPENDER_H
+
+#include "minirel.h"
+#include "page.h"
+
+class HeapFile;
+class HFPage;
+
+// Number of data pages an appender allocates from the DB at a time.
+const int APPEND_RUN = 8;
+
+// HeapFileAppender: inserts records at the end of a heap file, for loads
+// that only ever append.
+//
+// HeapFile::insertRecord looks up a page with room and pins, updates and
+// unpins both the data page and its directory page for every record; with
+// the write-through buffer manager that is two page writes per record.  An
+// appender instead keeps the data page it is filling and the last
+// directory page pinned, fills the data page completely, and writes it
+// (and updates its DataPageInfo) once, when it moves on to the next page.
+// New data pages are allocated APPEND_RUN at a time, so they end up next
+// to each other in the DB.
+//
+// The DataPageInfo of the page being filled shows its records but no
+// free space, so inserts through the HeapFile leave it alone.  While an
+// appender is open, its records may be read but must not be updated or
+// deleted.  Nothing is lost if the appender is not closed explicitly:
+// the destructor closes it, and so do HeapFile::deleteFile and the
+// HeapFile destructor if the appender is still open then.  Only the
+// destructor of the appender may be called after that.
+
+class HeapFileAppender {
+
+  public:
+    HeapFileAppender(HeapFile *hf, Status &status);
+   ~HeapFileAppender();
+
+    // Append a record to the file, like HeapFile::insertRecord.
+    Status append(char *recPtr, int recLen, RID &outRid);
+
+    // Append a whole data page built in memory (with HFPage::init and
+    // insertRecord, and no slot flags) holding recCnt records of recBytes
+    // bytes in all.  The page is copied to the next page of the run as it
+    // is, so its records get no per-record work; the page being filled is
+    // finished first, as it is.
+    Status appendPage(HFPage *image, int recCnt, int recBytes);
+
+    // Write the page being filled and give back the unused pages of the
+    // current run.  The appender cannot be used afterwards.
+    Status close();
+
+  private:
+    HeapFile *hf;
+
+    PageId  dataPageId;   // page being filled (INVALID_PAGE if none)
+    HFPage *dataPage;
+    PageId  dirPageId;    // pinned directory page (INVALID_PAGE if none)
+    HFPage *dirPage;
+    RID     dirRid;       // DataPageInfo of dataPage, on dirPage
+
+    PageId  runNext;      // next unused page of the current run
+    int     runLeft;      // number of unused pages left in the run
+
+    bool    closed;
+
+    HeapFileAppender *nextOpen;  // next open appender of hf
+
+    // Pin and initialize the next page of the run, and give it a
+    // directory entry.
+    Status startPage();
+
+    // Record the free space left on dataPage in its directory entry and
+    // write it out.
+    Status finishPage();
+
+    // Put a record (or an overflow stub) on the page being filled.
+    Status place(char *recPtr, int recLen, RID &outRid, int slotFlags);
+};
+
+#endif // _APPENDER_H
@@ -0,0 +1,55 @@
+#ifndef _ARENA_H
+#define _ARENA_H
+
+#include <vector>
+
+#include "minirel.h"
+#include "page.h"
+
+// Page ids at or above this are pages of a PageArena, not of the DB.
+const PageId ARENA_PAGE_BASE = 0x40000000;
+
+// An arena gets memory from the heap this many pages at a time.
+const int ARENA_CHUNK_PAGES = 32;
+
+// Default memory budget of a temporary heap file, in pages.
+const int TEMP_BUDGET_PAGES = 256;
+
+// PageArena: the pages of a temporary heap file that are kept in memory.
+//
+// A temporary HeapFile (one made with a null name) takes its pages from
+// its arena until the arena's budget is used up, and from the buffer
+// manager after that.  Arena pages never go to the DB: pinning one just
+// returns its memory, and freeing one puts it on a free list.  Their ids
+// start at ARENA_PAGE_BASE, so they never clash with DB pages, and a run
+// of them is addressed like a run of DB pages (firstPage + i).
+
+class PageArena {
+
+  public:
+    // An arena of at most budget pages
+    PageArena(int budget);
+   ~PageArena();
+
+    // true if pageId is the id of an arena page (allocated or not)
+    static bool owns(PageId pageId) { return pageId >= ARENA_PAGE_BASE; }
+
+    // Allocate a run of howmany consecutive pages.  Returns false, and
+    // allocates nothing, if the arena would go over its budget.
+    bool allocate(PageId &firstPageId, int howmany);
+
+    // Give back an allocated page
+    void deallocate(PageId pageId);
+
+    // Memory of an allocated page, NULL if pageId is not one
+    Page *page(PageId pageId);
+
+  private:
+    int                 budget;
+    int                 top;        // number of pages handed out so far
+    std::vector<Page *> chunks;     // ARENA_CHUNK_PAGES pages each
+    std::vector<bool>   allocated;  // per page below top
+    std::vector<int>    freeList;   // pages below top that were given back
+};
+
+#endif // _ARENA_H
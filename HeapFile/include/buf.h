@@ -11,6 +11,8 @@
 #include "new_error.h"
 #include <unordered_map>
 #include <functional>
+#include <mutex>
+#include <condition_variable>
 
 #define NUMBUF 20
 // Default number of frames, artifically small number for ease of debugging.
@@ -24,7 +26,7 @@
 
 // You could add more enums for internal errors in the buffer manager.
 enum bufErrCodes  {HASHMEMORY, HASHDUPLICATEINSERT, HASHREMOVEERROR, HASHNOTFOUND, QMEMORYERROR, QEMPTY, INTERNALERROR,
-    BUFFERFULL, BUFMGRMEMORYERROR, BUFFERPAGENOTFOUND, BUFFERPAGENOTPINNED, BUFFERPAGEPINNED};
+    BUFFERFULL, BUFMGRMEMORYERROR, BUFFERPAGENOTFOUND, BUFFERPAGENOTPINNED, BUFFERPAGEPINNED, BUFFERIOERROR};
 
 struct Descriptors {
     PageId page_number;
@@ -32,6 +34,7 @@ struct Descriptors {
     bool dirtybit;
     int hate;
     int love;
+    bool inTransit;  // being read or written with the latch released (and pinned meanwhile)
 };
 
 class Replacer; // may not be necessary as described below in the constructor
@@ -59,6 +62,36 @@ private:
     // hashTable.find(key) == hashTable.end() = !hashTable.containsKey(key)
     // hashTable.erase(key) =                   hashTable.remove(key)
     unordered_map<int, int, IDHash> *hashTable;
+    // Guards the frame descriptors and the hash table, so that threads can
+    // pin and unpin pages concurrently (see ParallelScan).  It is released
+    // for disk I/O: the frame is marked inTransit, pinned, and left in the
+    // hash table, so that other threads wait on frameReady for that page
+    // only, while pages already in the pool stay available to them.
+    mutex latch;
+    condition_variable frameReady;
+    // Held around the DB calls that change its space map (allocate and
+    // deallocate), and around page I/O that has to go through the DB.
+    // Recursive because those DB calls pin pages themselves.
+    recursive_mutex dbLatch;
+    // A descriptor of the DB file of our own, so that page reads and
+    // writes of different threads can run at once (pread/pwrite); -1
+    // until the DB is open
+    int dbFile;
+
+    // pinPage(), after a miss: load the page into a frame, replacing one
+    // if need be.  Returns DONE if another thread loaded it meanwhile.
+    Status loadPage(unique_lock<mutex> &lock, PageId pageId, Page *&page, int emptyPage);
+
+    // Write the frame of page pageId, which the caller has pinned, to disk
+    // with the latch released
+    Status writeFrame(unique_lock<mutex> &lock, PageId pageId, int frame);
+
+    // Wait until no frame of the pages pageIds (sorted) is in transit
+    void waitForIO(unique_lock<mutex> &lock, const PageId *pageIds, int count);
+
+    // Page I/O, called without the latch
+    Status readPage(PageId pageId, Page *page);
+    Status writePage(PageId pageId, Page *page);
 public:
     Page* bufPool; // The actual buffer pool
     Descriptors * bufDescr;
@@ -94,6 +127,12 @@ public:
     // User should call this method if it needs to delete a page
     // this routine will call DB to deallocate the page
 
+    Status freePages(PageId *pageIds, int count);
+    // Free many pages at once (pageIds is sorted in place).  Their frames
+    // are dropped without being written, and each run of consecutive
+    // pages is deallocated by a single DB call.  Fails, freeing nothing,
+    // if any of the pages is pinned.
+
     Status flushPage(PageId pageid);
     // Used to flush a particular page of the buffer pool to disk
     // Should call the write_page method of the DB class
@@ -0,0 +1,72 @@
+#ifndef _CLUSTER_H
+#define _CLUSTER_H
+
+#include "minirel.h"
+#include "page.h"
+#include <map>
+#include <string>
+#include <unordered_map>
+
+// ClusterMap: the data pages of a clustered heap file (see
+// HeapFile::setClustering) in key order.  Each page covers the keys from
+// its low key up to the low key of the next page, and a new record goes
+// to the page covering its key, so that records with nearby keys share
+// data pages.
+//
+// The key is one field of the record: an integer, a real, or a string
+// (compared like strncmp over its size).  Like the FreeSpaceMap, the map
+// only says where records should go; a page may hold keys outside its
+// range (records placed before clustering was turned on, or when their
+// page could not be split), and nothing depends on it being exact.
+
+class ClusterMap {
+
+  public:
+    // the key is the field of the given type and size at byte offset
+    ClusterMap(AttrType type, int offset, int size);
+
+    // Forget every page.
+    void clear();
+
+    // Data page pageId covers the keys from low up.  A page already
+    // covering keys from low is replaced.
+    void note(const char *low, PageId pageId);
+
+    // Data page pageId is no longer part of the file.
+    void forget(PageId pageId);
+
+    // The page covering key.  A key below every low key goes to the first
+    // page, which then covers it.  Returns false if no page is known.
+    bool find(const char *key, PageId &pageId);
+
+    // true if key is the low key of a page
+    bool isLow(const char *key) const;
+
+    // the key of a record, its size, and the length a record needs to
+    // have one
+    const char *keyOf(const char *recPtr) const { return recPtr + offset; }
+    int keySize() const { return size; }
+    int keyEnd() const { return offset + size; }
+
+    // <0, 0 or >0 as key a is below, equal to or above key b
+    int compare(const char *a, const char *b) const;
+
+    // true once every data page of the file has been looked at
+    bool complete;
+
+  private:
+    struct KeyLess {
+        const ClusterMap *map;
+        bool operator()(const string &a, const string &b) const {
+            return map->compare(a.data(), b.data()) < 0;
+        }
+    };
+
+    AttrType type;
+    int      offset;
+    int      size;
+    map<string, PageId, KeyLess> pages;     // low key -> data page
+    unordered_map<PageId, string> lows;     // data page -> low key
+};
+
+#endif // _CLUSTER_H
@@ -0,0 +1,139 @@
+#ifndef _CPAGE_H
+#define _CPAGE_H
+
+#include <vector>
+
+#include "minirel.h"
+#include "page.h"
+
+class HFPage;
+
+// Maximum number of columns a compressible record may have.
+const int MAX_CPAGE_COLS = 16;
+
+// Maximum number of records (live or deleted) on one compressed page.
+const int MAX_CPAGE_RECS = 2048;
+
+// RecordSchema: describes the fixed-size records of a heap file, in the
+// same (len_in, AttrType[], str_sizes[]) form the Sort class takes.
+// Integer and real fields are 4 bytes wide; string fields use str_sizes.
+struct RecordSchema {
+    int       numCols;
+    AttrType  types[MAX_CPAGE_COLS];
+    short     sizes[MAX_CPAGE_COLS];
+
+    RecordSchema();
+    RecordSchema(int len_in, const AttrType in[], const short str_sizes[]);
+
+    // total length in bytes of a record described by this schema
+    int recLen() const;
+
+    // byte offset of column col within a record
+    int offset(int col) const;
+};
+
+// Class definition for a compressed heap file data page.
+//
+// A full (sealed) HFPage can be rewritten in this column-wise format when
+// its records all follow a known RecordSchema.  Each column is encoded on
+// its own:
+//   - integers use frame-of-reference: a base value plus bit-packed deltas
+//   - strings use a dictionary (bit-packed codes) or run-length encoding,
+//     whichever is smaller
+//   - anything else is stored raw
+// The page is self-describing (the schema lives in the page), so readers
+// do not need to know how it was written.
+//
+// The fixed header lines up with the one of HFPage, so the prevPage,
+// nextPage and curPage of a compressed page can still be read through
+// HFPage, and HFPage::type tells the two formats apart.  Record i of the
+// page keeps slot number i, so sealing a page does not change any RID.
+// Deleted records are kept as bits in a deleted bitmap.
+//
+// A compressed page can always be turned back into an HFPage (see
+// unseal): it takes no more records than an HFPage could hold if each of
+// them were cut down to a stub of sizeof(RID) bytes.
+
+class CompressedPage {
+
+  protected:
+    static const int CPFIXED = 4 * sizeof(short)
+                             + 3 * sizeof(PageId);
+
+      // Warning:
+      // These items must all pack tight, (no padding) and must match
+      // the leading members of HFPage.
+
+    short     slotCnt;     // number of records encoded (live and deleted)
+    short     usedPtr;     // number of bytes of data[] in use
+    short     freeSpace;   // number of bytes free in data[]
+
+    short     type;        // always HFP_COMPRESSED
+
+    PageId    prevPage;    // backward pointer to data page
+    PageId    nextPage;    // forward pointer to data page
+    PageId    curPage;     // page number of this page
+
+    char      data[MAX_SPACE - CPFIXED];
+
+    // column encodings
+    enum { ENC_RAW, ENC_FOR, ENC_DICT, ENC_RLE };
+
+    // Layout of data[]:
+    //   numCols (1 byte), recLen (short)
+    //   per column: attr type (1), encoding (1), size (short), block offset (short)
+    //   deleted bitmap, ceil(slotCnt / 8) bytes
+    //   one encoded block per column
+    static const int COLHDR = 6;
+
+    int  numCols()           { return (unsigned char) data[0]; }
+    int  recLen();
+    int  colEncoding(int col){ return data[3 + col * COLHDR + 1]; }
+    int  colSize(int col);
+    int  colBlock(int col);
+    int  bitmapOffset()      { return 3 + numCols() * COLHDR; }
+    bool isDeleted(int i)    { return (data[bitmapOffset() + i / 8] >> (i % 8)) & 1; }
+
+    void getSchema(RecordSchema &schema);
+
+    // decode column col of record i into out
+    void decodeField(int col, int i, char *out);
+
+    // decode every record (live or not) into recs, slotCnt * recLen bytes
+    void decodeAll(char *recs, char *deleted);
+
+    // rebuild the page from n records (recs) and their deleted flags;
+    // returns DONE if the result does not fit in a page
+    Status encode(const RecordSchema &schema, const char *recs,
+                  const char *deleted, int n);
+
+    // true if n slots of records of len bytes could be unsealed
+    static bool unsealable(int n, int len);
+
+  public:
+    // Rewrite a full HFPage in compressed form.  Returns DONE (and leaves
+    // the page alone) if some record does not match the schema or if
+    // the compressed form would not be smaller.
+    static Status seal(HFPage *page, const RecordSchema &schema);
+
+    // Rewrite a compressed page as a plain HFPage again, keeping every
+    // slot number.  Records are laid out in slot order while the page has
+    // room for them; each of the others only gets a stub of sizeof(RID)
+    // zero bytes, flagged with stubFlags, and is appended to spilled (its
+    // RID to spilledRids) for the caller to store elsewhere.  Returns DONE
+    // if the page is not compressed.
+    static Status unseal(HFPage *page, int stubFlags, std::vector<RID> &spilledRids,
+                         std::vector<char> &spilled);
+
+    // The same operations as HFPage, on a compressed page.
+    Status insertRecord(char *recPtr, int recLen, RID& rid);
+    Status deleteRecord(const RID& rid);
+    Status updateRecord(const RID& rid, char *recPtr, int recLen);
+    Status firstRecord(RID& firstRid);
+    Status nextRecord (RID curRid, RID& nextRid);
+    Status getRecord(RID rid, char *recPtr, int& recLen);
+    int    available_space(void);
+    bool   empty(void);
+};
+
+#endif // _CPAGE_H
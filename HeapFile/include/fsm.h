@@ -0,0 +1,74 @@
+#ifndef _FSM_H
+#define _FSM_H
+
+#include "minirel.h"
+#include "page.h"
+#include <unordered_map>
+#include <vector>
+
+// Number of free-space classes.  A data page with avail bytes free is in
+// class avail / FSM_CLASS_BYTES (the last class takes everything above).
+const int FSM_CLASSES = 8;
+const int FSM_CLASS_BYTES = MAX_SPACE / FSM_CLASSES;
+
+// Number of data pages per class remembered in the file header.
+const int FSM_HINTS = 2;
+
+// FreeSpaceMap: an in-memory map of the data pages of a heap file,
+// bucketed by how much free space they have, so that an insert can pick
+// a page with room for its record in constant time.
+//
+// Each page is kept with the RID of its DataPageInfo in the directory,
+// so the directory entry can be updated with a single pin.  Once the map
+// is complete it also serves as the index from a data page to its
+// directory entry (see HeapFile::findDataPage).  What the map
+// says is only a hint: callers check the directory entry before trusting
+// it, and report the real free space back with note().
+
+class FreeSpaceMap {
+
+  public:
+    FreeSpaceMap();
+
+    // Forget every page.
+    void clear();
+
+    // Data page pageId, described by the directory entry dirRid, has
+    // avail bytes free.
+    void note(PageId pageId, const RID &dirRid, int avail);
+
+    // Data page pageId is no longer part of the file.
+    void forget(PageId pageId);
+
+    // Directory entry of data page pageId.  Returns false if the page has
+    // not been noted.
+    bool lookup(PageId pageId, RID &dirRid) const;
+
+    // Pick a data page that should have room for recLen bytes, preferring
+    // the fullest such page.  Returns false if no page is known to fit.
+    bool find(int recLen, PageId &pageId, RID &dirRid);
+
+    // Fill hints with the directory entries of up to FSM_HINTS pages per
+    // class (unused hints get pageNo INVALID_PAGE).
+    void saveHints(RID hints[FSM_CLASSES][FSM_HINTS]);
+
+    // true once every data page of the file has been noted, so that a
+    // failed find() means a new page is needed
+    bool complete;
+
+  private:
+    struct Entry {
+        RID dirRid;     // directory entry of the page
+        int avail;      // free bytes on the page
+        int cls;        // class of avail
+        int pos;        // index of the page in buckets[cls]
+    };
+
+    unordered_map<PageId, Entry> pages;
+    vector<PageId> buckets[FSM_CLASSES];
+
+    static int classOf(int avail);
+    void unlink(Entry &entry);
+};
+
+#endif // _FSM_H
@@ -23,6 +23,27 @@ private:
     int test5();
     int test6();
 
+      // Tests of the extensions to the heap file
+    int test7();
+    int test8();
+    int test9();
+    int test10();
+    int test11();
+    int test12();
+    int test13();
+    int test14();
+    int test15();
+    int test16();
+    int test17();
+    int test18();
+    int test19();
+    int test20();
+    int test21();
+    int test22();
+    int test23();
+    int test24();
+    int test25();
+
     Status runAllTests();
     const char* testName();
 };
@@ -4,7 +4,14 @@
 #include "minirel.h"
 #include "page.h"
 #include "hfpage.h"
+#include "cpage.h"
+#include "fsm.h"
+#include "cluster.h"
+#include "arena.h"
 #include "scan.h"
+#include "appender.h"
+#include "pscan.h"
+#include "analyze.h"
 #include "buf.h"
 #include "db.h"
 #include "new_error.h"
@@ -30,6 +37,11 @@
 //  directory page; for any given HeapFile insertion, it is likely
 //  that at least one of those referenced data pages will have
 //  enough free space to satisfy the request.
+//
+//  The first record of the first directory page is not a DataPageInfo
+//  but the HeapFileHeader (see below); directory walks skip it.  An
+//  insert finds a data page with room through a FreeSpaceMap (fsm.h)
+//  instead of walking the directory.
 
 // Error codes for HEAPFILE.
 enum heapErrCodes {
@@ -42,6 +54,12 @@ enum heapErrCodes {
     END_OF_PAGE,
     INVALID_SLOTNO,
     ALREADY_DELETED,
+    BAD_PREDICATE,
+    BAD_CURSOR,
+    BAD_PAGE,
+    NO_STATS,
+    IMPORT_IO,
+    BAD_ROW,
 };
 
 // DataPageInfo: the type of records stored on a directory page:
@@ -50,8 +68,87 @@ struct DataPageInfo {
   int    availspace;  // total available space of a page: HFPage returns int for avail space, so we use int here
   int    recct;       // number of records in the page: for efficient implementation of getRecCnt()
   PageId pageId;      // page id: id of this particular data page (a HFPage)
+  int    ovflct;      // number of those records that are overflow stubs (so deleteFile can skip the page if 0)
+};
+
+// HeapFileStats: statistics of a heap file, kept up to date by every
+// insert and delete (see HeapFile::getStats).
+struct HeapFileStats {
+  int       recCnt;       // number of records
+  int       dataPageCnt;  // number of data pages
+  long long recBytes;     // total length of the records (a large record counts in full)
+  long long freeBytes;    // free space on the data pages (sum of availspace)
+};
+
+// OpenFileStats: the statistics of a file while it is open.  Every
+// HeapFile open on the file shares the one OpenFileStats, so each sees
+// the changes of the others at once; the HeapFileHeader only gets them
+// when a HeapFile closes (or on HeapFile::flushStats), as writing the
+// header page for every record would cost a page write each time.
+struct OpenFileStats {
+  int           handles;  // number of HeapFiles sharing it
+  bool          listed;   // found by the file's first directory page (false once the file is deleted)
+  HeapFileStats stats;    // current statistics of the file
+};
+
+// HeapFileHeader: the first record of the first directory page.  It
+// keeps what a HeapFile caches about the file across opens: where the
+// directory ends, the file statistics, the page holding the TableStats
+// of the last analyze, and a few data pages with free space per
+// free-space class (as RIDs of their directory entries).  The free-space hints are only hints and are
+// checked before use.
+const int HEAPFILE_MAGIC = 0x48465033;      // "HFP3"
+
+struct HeapFileHeader {
+  int    magic;                             // HEAPFILE_MAGIC
+  PageId lastDirPageId;                     // last page of the directory chain
+  HeapFileStats stats;                      // statistics as of the last close
+  PageId statsPageId;                       // page of the TableStats (INVALID_PAGE if never analyzed)
+  RID    fsmHints[FSM_CLASSES][FSM_HINTS];  // see FreeSpaceMap::saveHints
+};
+
+// Records longer than this are stored out of line: the record goes to a
+// run of overflow pages and the data page only keeps an OverflowStub,
+// flagged with SLOT_OVERFLOW.  This keeps data pages dense, and a scan
+// only reads the overflow pages of the records it actually asks for.
+const int OVERFLOW_THRESHOLD = MAX_SPACE / 4;
+
+// OverflowStub: what a data page holds in place of a large record.
+// The record is stored, MINIBASE_PAGESIZE bytes per page, in numPages
+// consecutive pages starting at firstPage (a run from newPage(howmany)).
+struct OverflowStub {
+  int    totalLen;    // length of the record
+  PageId firstPage;   // first page of the overflow run
+  int    numPages;    // number of pages in the run
 };
 
+// A record that grows on update and no longer fits its page moves to
+// another page.  Its slot keeps a ForwardStub, flagged with SLOT_FORWARD,
+// so the RID stays valid and getRecord and scans find the record through
+// it.  The moved record is flagged with SLOT_MOVED and starts with the RID
+// of its home slot; scans skip it (it is returned at home) and compact()
+// uses the RID to fix the stub.  A record is never forwarded twice: if it
+// has to move again, the stub is pointed at the new place.
+struct ForwardStub {
+  RID    movedTo;     // where the record is now
+};
+
+// A data page with more free space than this is sparse: compact() moves
+// its records to other pages and frees it.
+const int COMPACT_SPARSE_SPACE = MAX_SPACE * 3 / 4;
+
+// RidForward: a record that compact() (or a clustered insert) moved from
+// oldRid to newRid.
+struct RidForward {
+  RID oldRid;
+  RID newRid;
+};
+
+// Called by compact() after it empties a data page, and by a clustered
+// insert after it splits one, with the records that moved off it, so that
+// an index on the file can fix its entries a page at a time.
+typedef void (*RidForwardCallback)(const RidForward *moves, int count, void *arg);
+
 class HeapFile {
 
   public:
@@ -61,11 +158,23 @@ class HeapFile {
     // If the name already denotes a file, the
     // file is opened; otherwise, a new empty file is created.
     // check if a file is deleted or not
-    HeapFile( const char *name, Status& returnStatus ); 
+    // A temporary heapfile is not entered in the DB; it keeps up to
+    // tempBudget pages in memory (see arena.h), and only pages beyond
+    // that go to the DB.
+    HeapFile( const char *name, Status& returnStatus, int tempBudget = TEMP_BUDGET_PAGES ); 
     ~HeapFile();
 
     // return number of records in file
     int getRecCnt();
+
+    // return the statistics of the file.  Like getRecCnt, this does not
+    // read any page, and counts the changes made through every HeapFile
+    // open on the file (see OpenFileStats).
+    Status getStats(HeapFileStats& fileStats);
+
+    // write the statistics to the file header now rather than when the
+    // HeapFile is closed
+    Status flushStats();
     
     // insert record into file
     Status insertRecord(char *recPtr, int recLen, RID& outRid); 
@@ -73,25 +182,202 @@ class HeapFile {
     // delete record from file
     Status deleteRecord(const RID& rid); 
 
-    // updates the specified record in the heapfile.
+    // updates the specified record in the heapfile.  The record may
+    // change length; it keeps its RID either way (see ForwardStub).
+    // A compressed page that cannot take the new record as it is goes
+    // back to plain form (see CompressedPage::unseal).
     Status updateRecord(const RID& rid, char *recPtr, int reclen);
 
     // read record from file, returning pointer and length as well as the actaul data
     Status getRecord(const RID& rid, char *recPtr, int& recLen); 
 
+    // copy len bytes, starting at byte offset, of a record stored out of
+    // line into buf.  Only the overflow pages holding those bytes are read.
+    Status readOverflow(const OverflowStub &stub, int offset, int len, char *buf);
+
     // initiate a sequential scan
     class Scan *openScan(Status& status);
 
-    // delete the file from the database
+    // initiate a sequential scan that shares its page reads with the other
+    // shared scans of this file.  It starts on the data page the shared
+    // scans last reached (which is likely still in the buffer pool), reads
+    // on to the end of the file, then wraps around to the data pages it
+    // missed.  Records come back in that order, each of them once.
+    class Scan *openSharedScan(Status& status);
+
+    // initiate a scan of a random sample of the file.  The same seed
+    // gives the same sample of an unchanged file.
+    // With a fraction, whole data pages are sampled: pages are picked at
+    // random until they hold about that fraction of the records (by the
+    // record counts in the directory), and only those pages are read,
+    // in file order.
+    // With a count n, n records are picked uniformly from the whole file,
+    // and only the pages holding them are read.  Such a scan takes no
+    // filter.
+    class Scan *openSampleScan(double fraction, unsigned int seed, Status& status);
+    class Scan *openSampleScan(int n, unsigned int seed, Status& status);
+
+    // delete the file from the database.  Appenders still open on the
+    // file are closed first, as they are by the destructor.
     Status deleteFile();
 
+    // Move the records of sparse data pages (see COMPACT_SPARSE_SPACE)
+    // into other pages, free the pages that are left empty, and pack the
+    // directory into as few pages as it needs.  forward (if not NULL) is
+    // told about every record that moved.  No scan of the file may be
+    // open while this runs.
+    Status compact(RidForwardCallback forward = NULL, void *arg = NULL);
+
+    // From now on, seal data pages in compressed form (see cpage.h) as
+    // soon as they are too full for another record of the given schema.
+    // Records that do not match the schema keep their page uncompressed.
+    Status setCompression(const RecordSchema &schema);
+
+    // Collect column statistics (see analyze.h) from a sample of up to
+    // sampleRows records, whose fields are laid out as schema says, and
+    // keep them on a page of the file, replacing those of the last
+    // analyze.  They are not kept up to date as the file changes.
+    Status analyze(const RecordSchema &schema, int sampleRows = ANALYZE_SAMPLE_ROWS);
+
+    // return the statistics of the last analyze; NO_STATS if there was none
+    Status getTableStats(TableStats &tableStats);
+
+    // From now on, place each new record by the value of column keyCol
+    // of schema (see cluster.h): on the data page covering its key, which
+    // is split when it is full, the upper half of its keys moving to a
+    // new page.  Records with nearby keys then share data pages, so a
+    // range scan through an index on the key reads few heap pages.
+    // forward (if not NULL) is told about the records a split moves, as
+    // in compact().  Records too short to hold the key, large records and
+    // records added through a HeapFileAppender are placed as usual.
+    Status setClustering(const RecordSchema &schema, int keyCol,
+                         RidForwardCallback forward = NULL, void *arg = NULL);
 
   private:
     friend class Scan;
+    friend class HeapFileAppender;
+    friend class ParallelScan;
 
     PageId      firstDirPageId;  // page number of header page
+    PageId      lastDirPageId;   // page number of the last directory page
+    FreeSpaceMap fsm;            // data pages by free space (see fsm.h)
     int         file_deleted;	 // flag for whether file is deleted (initialized to be false in constructor)
     char       *fileName;	 // heapfile name
+    RecordSchema *compressSchema; // schema used to seal full data pages (NULL if not compressing)
+    ClusterMap *cluster;         // data pages by key range (NULL if not clustering)
+    RidForwardCallback clusterForward; // told about the records a split moves
+    void       *clusterArg;      // argument of clusterForward
+    OpenFileStats *shared;       // statistics, shared with every HeapFile open on the file
+    PageId      statsPageId;     // page of the TableStats (INVALID_PAGE if never analyzed)
+    PageArena  *arena;           // in-memory pages of a temporary file (NULL otherwise)
+    int         sharedScans;     // number of open shared scans
+    HeapFileAppender *appenders; // open appenders (see closeAppenders)
+    ScanCursor  sharedPos;       // data page the shared scans last reached (magic 0 if none)
+
+    // Page access for everything in this file, in place of the buffer
+    // manager's methods of the same names: arena pages are handled here,
+    // the others passed on to the buffer manager
+    Status newPage(PageId &firstPageId, Page *&firstPage, int howmany = 1);
+    Status pinPage(PageId pageId, Page *&page, int emptyPage = 0);
+    Status unpinPage(PageId pageId, int dirty = FALSE, int hate = FALSE);
+    Status freePage(PageId pageId);
+    Status freePages(PageId *pageIds, int count);
+
+    // first/next DataPageInfo record of a directory page; skips the
+    // HeapFileHeader.  Return DONE when the page has no more.
+    static Status firstDirEntry(HFPage *dirPage, RID &rid);
+    static Status nextDirEntry(HFPage *dirPage, RID curRid, RID &nextRid);
+
+    // close the appenders still open on this file, so that none of them
+    // keeps pages pinned or refers to the HeapFile any more
+    Status closeAppenders();
+
+    // read the HeapFileHeader and the free-space hints it keeps, and the
+    // statistics too if loadStats
+    Status loadHeader(bool loadStats);
+
+    // write lastDirPageId, statistics, statsPageId and free-space hints back to the HeapFileHeader
+    Status saveHeader();
+
+    // find the OpenFileStats of the file, or start one (returns true if so)
+    bool openStats();
+
+    // let go of shared, freeing it after the last HeapFile on the file
+    void closeStats();
+
+    // walk the whole directory to put every data page in fsm
+    Status buildFreeSpaceMap();
+
+    // count the statistics of a file without a HeapFileHeader
+    Status countStats();
+
+    // seal a data page that is too full for another record of compressSchema
+    void sealDataPage(HFPage *dataPage);
+
+    // insert a record (or an overflow stub) on a data page, giving its
+    // slot the SLOT_* flags slotFlags
+    Status placeRecord(char *recPtr, int recLen, RID& outRid, int slotFlags);
+
+    // take the record rid off its data page, copying out what its slot
+    // holds (without the home RID of a moved record) and its SLOT_* flags.
+    // moved says whether rid should be a moved record.  The record count
+    // and overflow run are left to the caller.
+    Status eraseRecord(const RID& rid, bool moved, char *recPtr, int& recLen, int& flags);
+
+    // copy out the stored form (the record, or its OverflowStub) and
+    // SLOT_* flags of the record of slot home, which moved to movedRid
+    Status readMoved(const RID& home, const RID& movedRid, char *recPtr, int& recLen, int& flags);
+
+    // updateRecord(): store the new stored form of the record of slot rid,
+    // which has moved to *movedRid (NULL if it has not), moving it if needed
+    Status storeUpdate(const RID& rid, const RID *movedRid, char *recPtr, int recLen, int slotFlags);
+
+    // turn the compressed data page of rid back into a plain one, moving
+    // the records that do not fit to other pages
+    Status unsealDataPage(const RID& rid);
+
+    // make room on the data page of rid by moving its longest record
+    // (not rid's) elsewhere, leaving a ForwardStub (DONE if none is longer)
+    Status forwardLongest(const RID& rid);
+
+    // replace what slot rid holds, if its page has room (DONE if not)
+    Status replaceRecord(const RID& rid, char *recPtr, int recLen, int slotFlags);
+
+    // allocate an overflow run for a record of recLen bytes
+    Status newOverflow(int recLen, OverflowStub &stub);
+
+    // write a whole record to the overflow run of stub
+    Status writeOverflow(const OverflowStub &stub, const char *recPtr);
+
+    // give back the pages of an overflow run
+    Status freeOverflow(const OverflowStub &stub);
+
+    // add the pages of the overflow runs of all the large records on a
+    // data page to pages
+    Status collectOverflowRuns(PageId dataPageId, std::vector<PageId> &pages);
+
+    // insertRecord() in clustered mode: place a record on the page covering
+    // its key, splitting the page if it is full
+    Status placeClustered(char *recPtr, int recLen, RID& outRid);
+
+    // put a record on data page dataPageId (directory entry dirRid), if it
+    // has room (DONE if not)
+    Status placeOnPage(PageId dataPageId, const RID& dirRid, char *recPtr, int recLen, RID& outRid);
+
+    // move the records of the upper half of the keys of a full data page
+    // to a new page (DONE if its keys cannot be split)
+    Status splitPage(PageId dataPageId, const RID& dirRid);
+
+    // note the smallest key of every data page in cluster
+    Status buildClusterMap();
+
+    // add an empty data page to the file, and to the directory
+    Status addDataPage(PageId &dataPageId, RID &dirRid);
+
+    // compact(): move the records of a sparse data page elsewhere and
+    // free it, and pack the directory
+    Status vacatePage(PageId dataPageId, RidForwardCallback forward, void *arg);
+    Status packDirectory();
 
     // get new data pages through buffer manager
     // (dpinfop stores the information of allocated new data pages)
@@ -9,6 +9,23 @@
 const int INVALID_SLOT =  -1;
 const int EMPTY_SLOT   =  -1;
 
+// Values of HFPage::type for heap file data pages.
+// HFP_COMPRESSED pages are laid out as described in cpage.h.
+enum HFPageType { HFP_DATA = 0, HFP_COMPRESSED = 1 };
+
+// Record offsets within a page always fit in the low bits of a slot's
+// offset field; the high bits carry per-record flags.
+const short SLOT_OFFSET_MASK = 0x03FF;
+const short SLOT_OVERFLOW    = 0x0400;  // record is a stub for out of line data
+                                        // (see OverflowStub in heapfile.h)
+const short SLOT_FORWARD     = 0x0800;  // record moved on update, this is a stub
+                                        // to where it is now (see ForwardStub)
+const short SLOT_MOVED       = 0x1000;  // record moved here from the slot whose
+                                        // RID it starts with
+
+class Predicate;
+struct SlotList;
+
 // Class definition for a minibase data page.   
 // The design assumes that records are kept compacted when
 // deletions are performed. Notice, however, that the slot
@@ -18,12 +35,17 @@ const int EMPTY_SLOT   =  -1;
 
 class HFPage {
 
+    friend class CompressedPage;
+
   protected:
     struct slot_t {
-        short   offset;  
+        short   offset;    // offset of the record, plus SLOT_* flags
         short   length;    // equals EMPTY_SLOT if slot is not in use
     };
 
+    // offset of record no within data[], without the flags
+    int slotOffset(int no) { return slot[no].offset & SLOT_OFFSET_MASK; }
+
     static const int DPFIXED =       sizeof(slot_t)
                            + 4 * sizeof(short)
                            + 3 * sizeof(PageId);
@@ -58,6 +80,12 @@ class HFPage {
     void setPrevPage(PageId pageNo);    // sets value of prevPage to pageNo
 
     PageId page_no() { return curPage;} // returns the page number
+    void setPageNo(PageId pageNo) { curPage = pageNo; } // for a page image copied to page pageNo
+
+      // Returns true if the page has been sealed in compressed form.
+      // The record operations below work on both kinds of pages, except
+      // returnRecord which needs the record to be stored as is.
+    bool compressed() { return type == HFP_COMPRESSED; }
 
     // inserts a new record pointed to by recPtr with length recLen onto
     // the page, returns RID of record 
@@ -66,6 +94,11 @@ class HFPage {
     // delete the record with the specified rid
     Status deleteRecord(const RID& rid);
 
+    // replace the record with RID rid by recLen bytes at recPtr, keeping
+    // its RID and flags; returns DONE if the page has no room for the
+    // longer record
+    Status updateRecord(RID rid, char *recPtr, int recLen);
+
       // returns RID of first record on page
       // returns DONE if page contains no records.  Otherwise, returns OK
     Status firstRecord(RID& firstRid);
@@ -80,6 +113,20 @@ class HFPage {
       // returns a pointer to the record with RID rid
     Status returnRecord(RID rid, char*& recPtr, int& recLen);
 
+      // tests every record of the page against pred and puts the slots
+      // of those that satisfy it in out; returns out.count.  Records
+      // stored out of line (SLOT_OVERFLOW) or moved away (SLOT_FORWARD)
+      // cannot be tested on the page and are always selected; records that
+      // moved here (SLOT_MOVED) never are.
+    int    select(const Predicate &pred, SlotList &out);
+
+      // returns the SLOT_* flags of the record with RID rid
+      // (always 0 on a compressed page)
+    int    slotFlags(RID rid);
+
+      // sets the SLOT_* flags of the record with RID rid
+    Status setSlotFlags(RID rid, int flags);
+
       // returns the amount of available space on the page
     int    available_space(void);
 
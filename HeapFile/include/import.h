@@ -0,0 +1,108 @@
+#ifndef _IMPORT_H
+#define _IMPORT_H
+
+#include <vector>
+
+#include "minirel.h"
+#include "page.h"
+#include "cpage.h"
+#include "appender.h"
+
+class HeapFile;
+class HFPage;
+
+// Formats HeapFileImporter reads.  A CSV row is one line of
+// comma-separated fields, one per column of the schema; a field may be
+// quoted ("a, b" with "" for a quote, but no newline), integers and
+// reals are written as strtol and strtof read them, and strings longer
+// than their column are cut.  A binary row is a record as it is stored:
+// schema.recLen() bytes.
+enum ImportFormat {
+    IMPORT_CSV,
+    IMPORT_BINARY,
+};
+
+// Number of bytes of input each worker parses at a time.
+const int IMPORT_CHUNK = 4 << 20;
+
+// HeapFileImporter: loads rows from a file into a heap file.
+//
+// The input is read IMPORT_CHUNK bytes per worker at a time.  Each chunk
+// is cut at row boundaries into one piece per worker, and the workers
+// parse their pieces in parallel, straight into page images.  The images
+// are then appended to the file in input order through a
+// HeapFileAppender (see HeapFileAppender::appendPage), each with one
+// directory update, so records keep the order of the input.  The last
+// page a worker fills from its piece is usually not full.
+//
+// Rows longer than OVERFLOW_THRESHOLD are appended one at a time.  The
+// file must not be used otherwise while an import is going.
+
+class HeapFileImporter {
+
+  public:
+    // An importer of rows laid out as schema says, with numWorkers
+    // threads (the calling thread is one of them).
+    HeapFileImporter(HeapFile *hf, const RecordSchema &schema, ImportFormat format, int numWorkers,
+                     Status &status);
+   ~HeapFileImporter();
+
+    // Import every row of the file at path.  On BAD_ROW, errorRow() is
+    // the (0-based) line of the file (row, for binary input) that is bad;
+    // the rows of the chunks before the one it is in have been imported.
+    Status importFile(const char *path);
+
+    // Import the rows in the len bytes at data, which end at a row
+    // boundary (or the last CSV row just lacks its newline).
+    Status importData(const char *data, long len);
+
+    // Rows imported so far, and the row importFile stopped at.
+    long long rows() const { return rowCnt; }
+    long long errorRow() const { return badRow; }
+
+  private:
+    // What a worker made of its piece of a chunk
+    struct Piece {
+        const char         *begin;
+        const char         *end;
+        std::vector<Page *> pages;      // page images; the first used of them
+        std::vector<int>    recCnts;    // records on each of them
+        std::vector<int>    recBytes;   // bytes of records on each of them
+        std::vector<char>   large;      // records too long for a page image
+        int                 used;       // images filled
+        long long           rows;       // rows parsed
+        long long           lines;      // lines parsed, blank ones too (rows, for binary input)
+        long long           badRow;     // line of the piece that is bad (-1 if none)
+        Status              status;
+    };
+
+    HeapFile         *hf;
+    RecordSchema      schema;
+    int               offsets[MAX_CPAGE_COLS];  // byte offset of each column
+    ImportFormat      format;
+    int               numWorkers;
+    HeapFileAppender *appender;     // open while importing
+    Piece            *pieces;       // one per worker
+    long long         rowCnt;       // rows imported
+    long long         lineCnt;      // lines of input imported
+    long long         badRow;       // line of the bad row (-1 if none)
+
+    // Import the rows in the len bytes at data through appender
+    Status load(const char *data, long len);
+
+    // Parse the rows of a piece into its page images
+    void parse(Piece &piece);
+
+    // Encode the CSV row at *pos (and move *pos past it) as a record.
+    // Returns false if it is malformed; blank is set for a blank line.
+    bool parseCsvRow(const char *&pos, const char *end, char *rec, bool &blank);
+
+    // Put a record on the current page image of piece (or with its
+    // large records)
+    void addRecord(Piece &piece, const char *rec, int recLen);
+
+    // Where the last complete row of the len bytes at data ends
+    long rowsEnd(const char *data, long len);
+};
+
+#endif // _IMPORT_H
@@ -0,0 +1,75 @@
+#ifndef _PREDICATE_H
+#define _PREDICATE_H
+
+#include "minirel.h"
+#include "cpage.h"
+
+// Maximum number of terms in a predicate.
+const int MAX_PRED_TERMS = 8;
+
+// Maximum length of a string field a predicate can test.
+const int MAX_PRED_STRLEN = 32;
+
+// Predicate: a selection condition on the fields of a record, in a form
+// that can be tested straight against the bytes of a record on a page.
+//
+// A predicate is the conjunction of its terms.  Each term compares one
+// field (an attrInteger, attrReal or attrString at a byte offset in the
+// record) against constants with an AttrOperator.  aopRANGE keeps values
+// in [value, value2], aopNOP is always true, and aopNOT is not supported.
+//
+// The terms are compiled when they are added: integer and real terms
+// become one closed range [lo, hi] (possibly negated, for aopNE), so
+// testing a record does not need to look at the operator again.
+
+class Predicate {
+
+  public:
+    Predicate();
+
+    // Add a term on the 4 byte integer field at offset.
+    Status addInt(int offset, AttrOperator op, int value, int value2 = 0);
+
+    // Add a term on the 4 byte real field at offset.
+    Status addReal(int offset, AttrOperator op, float value, float value2 = 0);
+
+    // Add a term on the string field of size bytes at offset.  Strings
+    // compare like strncmp over size bytes.
+    Status addString(int offset, int size, AttrOperator op,
+                     const char *value, const char *value2 = NULL);
+
+    // true if the record of recLen bytes at rec satisfies every term
+    bool matches(const char *rec, int recLen) const;
+
+    // number of leading bytes of a record the terms look at
+    int extent() const { return ext; }
+
+  private:
+    struct Term {
+        AttrType     type;
+        AttrOperator op;            // kept for strings only
+        short        offset;
+        short        size;
+        bool         negate;        // true for aopNE
+        int          ilo, ihi;      // attrInteger: lo <= x <= hi
+        float        flo, fhi;      // attrReal:    lo <= x <= hi
+        char         slo[MAX_PRED_STRLEN];
+        char         shi[MAX_PRED_STRLEN];
+    };
+
+    Term terms[MAX_PRED_TERMS];
+    int  numTerms;
+    int  ext;            // see extent()
+    bool never;          // some term can never hold
+
+    Status addTerm(AttrType type, int offset, int size, AttrOperator op, Term *&term);
+};
+
+// SlotList: the slots of one page selected by HFPage::select, in slot
+// order.  A compressed page may hold up to MAX_CPAGE_RECS records.
+struct SlotList {
+    int   count;
+    short slotNo[MAX_CPAGE_RECS];
+};
+
+#endif // _PREDICATE_H
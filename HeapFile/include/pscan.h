@@ -0,0 +1,100 @@
+#ifndef _PSCAN_H
+#define _PSCAN_H
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "minirel.h"
+#include "scan.h"
+
+// Number of consecutive data pages in a morsel, the unit of work handed
+// to a worker.
+const int MORSEL_PAGES = 16;
+
+// Maximum number of worker threads of a parallel scan.
+const int MAX_SCAN_WORKERS = 64;
+
+// Called by ParallelScan::run for every record, on the worker thread that
+// found it.  worker is the number of that thread (0 to workers()-1), so
+// callers can keep one accumulator per worker and combine them at the
+// end.  view follows the same rules as for Scan::getNextView, except that
+// it is only valid during the call.
+typedef void (*RecordCallback)(int worker, const RecordView &view, void *arg);
+
+// ParallelScan: a full scan of a heap file by several threads at once.
+//
+// run() reads the directory once and cuts the data pages into morsels of
+// MORSEL_PAGES pages.  Each worker starts with an even share of the
+// morsels in its own queue, takes morsels from the front of that queue,
+// and when it runs out steals from the back of another worker's queue, so
+// workers that hit slow pages do not hold up the others.  Each worker has
+// its own cursor into the page it is reading and pins pages itself, which
+// the BufMgr latch makes safe.
+//
+// The file must not be updated while run() is going.
+
+class HeapFile;
+
+class ParallelScan {
+
+  public:
+    // A scan of hf with numWorkers threads (the calling thread is one of
+    // them).
+    ParallelScan(HeapFile *hf, int numWorkers, Status &status);
+   ~ParallelScan();
+
+    // Only pass records that satisfy pred to the callback, as with
+    // Scan::setFilter.  NULL passes every record.
+    Status setFilter(const Predicate *pred);
+
+    // Call callback(worker, view, arg) for every record in the file.
+    // Returns the first error any worker ran into.
+    Status run(RecordCallback callback, void *arg);
+
+    // Read part of a record stored out of line, as Scan::readOverflow.
+    // Safe to call from the callback.
+    Status readOverflow(const RecordView &view, int offset, int len, char *buf);
+
+    // Number of worker threads
+    int workers() const { return numWorkers; }
+
+  private:
+    // Pages pages[first] .. pages[first + count - 1]
+    struct Morsel {
+        int first;
+        int count;
+    };
+
+    // Morsels waiting for a worker; the owner takes from the front and
+    // thieves from the back.
+    struct MorselQueue {
+        std::mutex         lock;
+        std::deque<Morsel> morsels;
+    };
+
+    HeapFile            *hf;
+    int                  numWorkers;
+    const Predicate     *filter;
+    std::vector<PageId>  pages;     // data pages of the file, in directory order
+    MorselQueue         *queues;    // one per worker
+
+    // Read the directory into pages, and deal the morsels out to the queues
+    Status plan();
+
+    // Next morsel for worker, its own or a stolen one.  false when every
+    // queue is empty.
+    bool nextMorsel(int worker, Morsel &morsel);
+
+    // Work off morsels until none are left
+    Status work(int worker, RecordCallback callback, void *arg);
+
+    // Pass the records of one data page to the callback
+    Status scanPage(int worker, PageId pageId, RecordCallback callback, void *arg,
+                    char *recBuf, SlotList &selected);
+
+    // Test a record stored out of line against filter
+    bool matchOverflow(const RecordView &view);
+};
+
+#endif // _PSCAN_H
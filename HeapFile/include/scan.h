@@ -7,6 +7,7 @@
 #define _SCAN_H_
 
 #include "minirel.h"
+#include "predicate.h"
 
 // ***********************************************************
 // A Scan object is created ONLY through the function openScan
@@ -18,6 +19,66 @@
 
 class HeapFile;
 class HFPage;
+struct SamplePlan;
+
+// RecordView: a record returned in place by Scan::getNextView, without
+// copying it out of the buffer pool.  ptr points into the pinned data
+// page (or, for a compressed page or a record that moved on update,
+// into a buffer owned by the scan).  A view stays valid until the scan
+// moves off that page; views into the scan's buffer only stay valid
+// until the next call.
+//
+// A record stored out of line is not read by getNextView: the view has
+// overflow set, ptr/len describe its OverflowStub (see heapfile.h), and
+// Scan::readOverflow reads the parts of the record that are needed.
+struct RecordView {
+    const char *ptr;      // first byte of the record
+    int         len;      // length of the record
+    RID         rid;      // RID of the record
+    bool        overflow; // true if ptr/len are the record's OverflowStub
+};
+
+// ScanCursor: the position of a scan, as returned by Scan::saveCursor.
+// It names the directory entry and data page the scan is on, so
+// restoreCursor goes straight back there without walking the file.  It
+// holds no pointers and can be written out as is, to resume a long scan
+// later (on the same file, as long as that data page still exists).
+const int SCAN_CURSOR_MAGIC = 0x53435231;  // "SCR1"
+
+struct ScanCursor {
+    int    magic;          // SCAN_CURSOR_MAGIC
+    PageId dirPageId;      // directory page of the data page's entry
+    RID    dataPageRid;    // the data page's DataPageInfo on that page
+    PageId dataPageId;     // data page of the next record (INVALID_PAGE at the end)
+    RID    userRid;        // next record to look at on that page
+    int    nxtUserStatus;  // OK, or DONE if the data page is used up
+};
+
+// Maximum number of records in a RecordBatch.
+const int BATCH_MAX_RECS = 256;
+
+// Maximum number of data pages the records of one batch may come from.
+const int BATCH_MAX_PAGES = 8;
+
+// RecordBatch: up to capacity records returned at once by
+// Scan::getNextBatch, as RecordViews.  The batch may span several data
+// pages; the scan keeps all of them pinned until the next call to
+// getNextBatch (or until the scan is deleted), so every view in the batch
+// stays valid until then.  Records of compressed pages, and records that
+// moved on update, are copied into the batch itself.
+struct RecordBatch {
+    int        capacity;                // most records per batch, up to BATCH_MAX_RECS
+    int        count;                   // records in this batch
+    RecordView recs[BATCH_MAX_RECS];
+    char       decoded[BATCH_MAX_PAGES * MINIBASE_PAGESIZE];
+
+    RecordBatch(int capacity = BATCH_MAX_RECS);
+
+    // Copy the 4 byte integer (real) field at offset of every record of a
+    // fixed-size schema into out[0 .. count-1], as one column.
+    void gatherInt(int offset, int *out) const;
+    void gatherReal(int offset, float *out) const;
+};
 
 class Scan {
 
@@ -32,11 +93,36 @@ class Scan {
     // Also returns the RID of the retrieved record.
     Status getNext(RID& rid, char *recPtr, int& recLen);
 
-    // Position the scan cursor to the record with the given rid.
-    // Returns OK if successful, non-OK otherwise.
+    // Retrieve the next record in a sequential scan without copying it.
+    // See RecordView for how long the view may be used.
+    Status getNextView(RecordView& view);
+
+    // Retrieve the next records of the scan, crossing data pages as
+    // needed.  Returns DONE (with batch.count 0) at the end of the file.
+    Status getNextBatch(RecordBatch& batch);
+
+    // Copy len bytes, starting at byte offset, of the out of line record
+    // behind view (one with view.overflow set) into buf.
+    Status readOverflow(const RecordView& view, int offset, int len, char *buf);
+
+    // From now on only return records that satisfy pred; NULL returns
+    // every record again.  The scan keeps a pointer to pred, and tests
+    // a whole data page at a time with HFPage::select.
+    Status setFilter(const Predicate *pred);
+
+    // Position the scan cursor to the record with the given rid, so that
+    // it is the next record returned.  Returns OK if successful, non-OK
+    // otherwise.
     Status position(RID rid);
 
+    // Save the position of the scan in cursor, and go back to a saved
+    // position.  Both pin at most one directory page and one data page.
+    Status saveCursor(ScanCursor& cursor);
+    Status restoreCursor(const ScanCursor& cursor);
+
   private:
+    friend class HeapFile;
+
     /*
      * See heapfile.h for the overall description of a heapfile.
      * (Then see hfpage.h for HFPage ops.)
@@ -72,6 +158,74 @@ class Scan {
     // status value of whether next record exists
     int     nxtUserStatus;
 
+    // records of compressed pages are decoded here by getNextView
+    char    viewBuf[MINIBASE_PAGESIZE];
+
+    // selection set by setFilter (NULL if none)
+    const Predicate *filter;
+
+    // slots of the data page selectedPage that satisfy filter;
+    // userRid is selected.slotNo[selectedPos]
+    SlotList selected;
+    int      selectedPos;
+    PageId   selectedPage;
+
+    // shared scan state (see HeapFile::openSharedScan): startPageId is
+    // the data page the scan joined at (INVALID_PAGE if it started at
+    // the beginning of the file), and wrapped is set once it has gone
+    // back to the first data page
+    bool     shared;
+    bool     wrapped;
+    PageId   startPageId;
+
+    // Join the shared scans of the file
+    Status share();
+
+    // Move to the next data page, wrapping around for a shared scan
+    Status nextPage();
+
+    // the data pages (and for a row sample, the records on them) a
+    // sample scan visits; NULL for a full scan
+    SamplePlan *sample;
+
+    // Make this a sample scan (see HeapFile::openSampleScan): of whole
+    // data pages holding about fraction of the records if rows < 0, of
+    // rows records otherwise
+    Status planSample(double fraction, int rows, unsigned int seed);
+
+    // Move to the next data page of the sample
+    Status nextSamplePage();
+
+    // Slots of the sampled records on the current data page
+    void sampleSlots(SlotList &slots);
+
+    // data pages pinned once more for the views of the last batch
+    PageId   heldPages[BATCH_MAX_PAGES];
+    int      numHeld;
+
+    // Unpin the pages of the last batch
+    Status releaseHeld();
+
+    // Unpin the current pages and continue from data page dataPageId
+    // (described by dataPageRid on directory page dirPageId), which the
+    // caller has pinned
+    Status moveTo(PageId dirPageId, HFPage *dirPage, RID dataPageRid,
+                  PageId dataPageId, HFPage *dataPage);
+
+    // Move userRid past the record just returned
+    void step();
+
+    // Test a record stored out of line or moved away against filter
+    bool matchOutOfLine();
+
+    // Copy out the current record as its slot (or, if it moved on update,
+    // the slot it moved to) holds it, with its SLOT_* flags
+    Status readStored(char *recPtr, int& recLen, int& flags);
+
+    // Make sure userRid names a record, moving to the next data page if
+    // the current one is used up.  Returns DONE at the end of the file.
+    Status advance();
+
     // Do all the constructor work
     Status init(HeapFile *hf);
 
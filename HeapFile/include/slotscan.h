@@ -0,0 +1,36 @@
+#ifndef _SLOTSCAN_H
+#define _SLOTSCAN_H
+
+// Slot directory search kernels.
+//
+// A page slot is a {short offset, short length} pair, and a slot is free
+// when its length is EMPTY_SLOT (-1).  These routines look at 8 to 16
+// slots per step with AVX2 or SSE4.1 when the processor has them, and use
+// a plain loop otherwise.  The choice is made once, at run time, so the
+// same binary runs on any x86 machine (and anywhere else, as scalar code).
+//
+// nextLiveSlot, which record walks call once per record, first steps over
+// a few slots one at a time: on pages with few deleted slots the next
+// used slot is nearly always among them, and a vector search would cost
+// more than it saves.  Only a longer run of free slots goes to the
+// kernel, which is where pages with many deleted slots gain (see
+// slotbench.C).
+//
+// slots points at slot 0 of the directory and last is the index of the
+// last slot (HFPage::slotCnt).  Nothing past slots[last] is ever read.
+
+// Returns the index of the first used slot in slots[from..last], or
+// last + 1 if they are all free.
+int nextLiveSlot(const void *slots, int from, int last);
+
+// Returns the number of used slots in slots[0..last].
+int countLiveSlots(const void *slots, int last);
+
+// The plain loop versions of the above, whatever the processor.
+int nextLiveSlotScalar(const void *slots, int from, int last);
+int countLiveSlotsScalar(const void *slots, int last);
+
+// Name of the kernels picked at run time: "avx2", "sse4.1" or "scalar".
+const char *slotScanKernel();
+
+#endif // _SLOTSCAN_H
@@ -94,6 +94,12 @@ public:
     // User should call this method if it needs to delete a page
     // this routine will call DB to deallocate the page
 
+    Status freePages(PageId *pageIds, int count);
+    // Free many pages at once (pageIds is sorted in place).  Their frames
+    // are dropped without being written, and each run of consecutive
+    // pages is deallocated by a single DB call.  Fails, freeing nothing,
+    // if any of the pages is pinned.
+
     Status flushPage(PageId pageid);
     // Used to flush a particular page of the buffer pool to disk
     // Should call the write_page method of the DB class
@@ -42,6 +42,7 @@ enum heapErrCodes {
     END_OF_PAGE,
     INVALID_SLOTNO,
     ALREADY_DELETED,
+    BAD_CURSOR,
 };
 
 // DataPageInfo: the type of records stored on a directory page:
@@ -18,6 +18,30 @@
 class HeapFile;
 class HFPage;
 
+// RecordView: a record returned in place by Scan::getNextView, without
+// copying it out of the buffer pool.  ptr points into the pinned data
+// page, so a view stays valid until the scan moves off that page.
+struct RecordView {
+    const char *ptr;    // first byte of the record
+    int         len;    // length of the record
+    RID         rid;    // RID of the record
+};
+
+// ScanCursor: the position of a scan, as returned by Scan::saveCursor.
+// It names the directory entry and data page the scan is on, so
+// restoreCursor goes straight back there instead of rescanning the file
+// the way position() does.
+const int SCAN_CURSOR_MAGIC = 0x53435231;  // "SCR1"
+
+struct ScanCursor {
+    int    magic;          // SCAN_CURSOR_MAGIC
+    PageId dirPageId;      // directory page of the data page's entry
+    RID    dataPageRid;    // the data page's DataPageInfo on that page
+    PageId dataPageId;     // data page of the next record
+    RID    userRid;        // next record to look at on that page
+    int    nxtUserStatus;  // OK, or DONE if the data page is used up
+};
+
 class Scan {
 
   public:
@@ -31,10 +55,20 @@ class Scan {
     // Also returns the RID of the retrieved record.
     Status getNext(RID& rid, char *recPtr, int& recLen);
 
+    // Retrieve the next record in a sequential scan without copying it.
+    // See RecordView for how long the view may be used.
+    Status getNextView(RecordView& view);
+
     // Position the scan cursor to the record with the given rid.
     // Returns OK if successful, non-OK otherwise.
     Status position(RID rid);
 
+    // Save the position of the scan in cursor, and go back to a saved
+    // position of this scan.  Restoring pins one directory page and one
+    // data page.
+    Status saveCursor(ScanCursor& cursor);
+    Status restoreCursor(const ScanCursor& cursor);
+
   private:
     /*
      * See heapfile.h for the overall description of a heapfile.
@@ -8,6 +8,8 @@
 #ifndef _BTREE_H
 #define _BTREE_H
 
+#include <vector>
+
 #include "btindex_page.h"
 #include "btleaf_page.h"
 #include "index.h"
@@ -28,7 +30,18 @@ struct IndexPage {
     PageId indexPageId;
 };
 
+// First key of a page, and the page; bulkLoad makes one index entry of each
+struct BulkLoadEntry {
+    KeyType key;
+    PageId pageId;
+};
+
+// Fraction of each page bulkLoad fills, leaving the rest for later inserts
+const float BULKLOAD_FILL = 0.9f;
+
 class BTreeFile : public IndexFile {
+    friend class BTreeTest;     // the driver walks the leaf level to check its shape
+
 public:
     BTreeFile(Status& status, const char *filename);
     // an index with given filename should already exist,
@@ -47,9 +60,16 @@ public:
     // insert <key,rid> into appropriate leaf page
 
     Status Delete(const void *key, const RID rid);
-    // delete leaf entry <key,rid> from the appropriate leaf
-    // you need not implement merging of pages when occupancy
-    // falls below the minimum threshold (unless you want extra credit!)
+    // delete leaf entry <key,rid> from the appropriate leaf; a page left
+    // less than half full borrows entries from a sibling or is merged
+    // with it, up the tree, and the root goes when it has one child left
+
+    Status bulkLoad(IndexFileScan *source, float fillFactor = BULKLOAD_FILL);
+    // build an empty index from the <key,rid> pairs source gives in
+    // increasing key order (e.g. a BTreeFileScan of another index),
+    // filling each page to fillFactor; keys equal to the one before
+    // are skipped, as insert does.  A load that fails leaves the index
+    // empty again
 
     IndexFileScan *new_scan(const void *lo_key = NULL, const void *hi_key = NULL);
     // create a scan with given keys
@@ -78,7 +98,21 @@ private:
 
     Status splitLeafPage(BTLeafPage* leafPage, PageId leafPageId, int height, const void* key, const RID rid);
 
-    Status splitIndexPage(BTIndexPage *page, PageId pageId, int height, void* recKey);
+    Status splitIndexPage(BTIndexPage *page, PageId pageId, int height, const void* recKey, PageId recPageId);
+
+    Status buildIndexLevel(std::vector<BulkLoadEntry>& children, int reserve, std::vector<PageId>& built);
+
+    Status nextBulkPage(SortedPage*& page, PageId& pageId, NodeType type, std::vector<PageId>& built);
+
+    Status undoBulkLoad(PageId pinnedId, std::vector<PageId>& built, Status error);
+
+    Status rebalance(PageId pageId, int level);
+
+    void unpinRebalanced(PageId pageId, PageId siblingId, PageId parentId, bool dirty);
+
+    Status shrinkRoot();
+
+    Status moveEntry(SortedPage *from, RID rid, SortedPage *to);
 
     void printPage();
 
@@ -43,8 +43,8 @@ public:
 
 // ------------------ get_page_no -----------------------
 // This function encapsulates the search routine to search a
-// BTIndexPage. It uses the standard search routine as
-// described in the textbook, and returns the page_no of the
+// BTIndexPage. It binary searches the entries in place
+// (SortedPage::findSlot), and returns the page_no of the
 // child to be searched next.
 
     Status get_page_no(const void *key, AttrType key_type, PageId &pageNo);
@@ -68,11 +68,11 @@ public:
 
 
 // ------------------ get_data_rid -----------------------
-// This function performs a sequential search (or a
-// binary search if you are ambitious) to find a data entry
-// of the form <key, dataRid>, where key is given in the call.
-// It returns the dataRid component of the pair; note that this
-// is the rid of the DATA record, and NOT the rid of the data entry!
+// This function performs a binary search (SortedPage::findSlot)
+// to find a data entry of the form <key, dataRid>, where key is
+// given in the call.  It returns the rid of the data entry itself,
+// which the BTreeFile uses to delete it; RECNOTFOUND if there is
+// no such entry, and NOMORERECS if the page is empty.
 
     Status get_data_rid(const void *key, AttrType attrtype, RID &dataRid);
 
@@ -12,9 +12,15 @@ Status runTests();
  void test2();
  void test3();
  void test4();
+ void test5();
+ void test6();
+ void test7();
  void menu();
  void PrintInfo(BTreeFile* btf);
  void test_scan(IndexFileScan* scan);
+ int countLeaves(BTreeFile* btf, int& entries);
+ int countIndexPages(BTreeFile* btf, PageId pageId, int& underflows);
+ int checkScan(IndexFileScan* scan, IndexFileScan* expected);
 
 };
 
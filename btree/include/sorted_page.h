@@ -70,9 +70,34 @@ public:
     // return number of records
     int numberOfRecords();
 
+// Binary search of the slot directory for key, comparing it with the
+// keys in place on the page.  Returns the last used slot whose key is
+// <= key, or -1 if every key on the page is greater (or the page is
+// empty); exact is set if that slot's key equals key.  Empty slots left
+// by deleteRecord are skipped.
+    int findSlot(const void *key, AttrType keyType, bool &exact);
+
     // return free spacce
     int free_space() { return freeSpace; }
 
+    // Space a page keeps in use, except the root: BTreeFile::Delete
+    // refills or merges a page whose entries take less than this
+    static const int MIN_USED_SPACE = (MAX_SPACE - DPFIXED) / 2;
+
+    // space the slot of an entry takes
+    static const int SLOT_SPACE = sizeof(slot_t);
+
+    // return the space the entries and their slots take up (empty
+    // slots, which inserts reuse, do not count)
+    int used_space();
+
+    // true if count more entries, of length bytes in all, fit on the
+    // page, reusing its empty slots
+    bool can_take(int count, int length);
+
+    // true if the page is below MIN_USED_SPACE
+    bool underflow() { return used_space() < MIN_USED_SPACE; }
+
     // set node type
     void set_type(short t) { type = t; }
 